@@ -0,0 +1,207 @@
+/*!
+    \file
+    \brief Bit-sliced Reed-Solomon (n+16,n) encoding of codeword batches.
+    \authors Bliznets R.A. (r.bliznets@gmail.com)
+    \version 1.0.1.0
+    \date 18.10.2026
+*/
+
+#include "RSBitSlice.h"
+#include <cassert>
+#include <cstring>
+#include <utility>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+
+#include "rs_gf256.h"
+
+/// Generator polynomial coefficients (without the leading 1), same as RSEncode16::m_G.
+static constexpr uint8_t s_gen[16] = {RS_G};
+
+/// Input bits of the output bit of the multiplication by a constant.
+/*!
+    \param[in] k constant.
+    \param[in] o output bit.
+    \return mask of the input bits.
+*/
+static constexpr uint8_t mul_mask(uint8_t k, uint32_t o)
+{
+    uint8_t res = 0;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        if ((gf_mul(k, 1 << i) >> o) & 1)
+            res |= 1 << i;
+    }
+    return res;
+}
+
+/// Input bit-plane if it takes part in the output bit.
+template <typename T, uint8_t K, uint32_t O, uint32_t I>
+static inline T mul_term(const T *in)
+{
+    if constexpr ((mul_mask(K, O) >> I) & 1)
+        return in[I];
+    else
+        return 0;
+}
+
+/// Output bit-plane of the multiplication by a constant (XOR of the input bit-planes).
+template <typename T, uint8_t K, uint32_t O, uint32_t... I>
+static inline T mul_bit(const T *in, std::integer_sequence<uint32_t, I...>)
+{
+    return (mul_term<T, K, O, I>(in) ^ ...);
+}
+
+/// Multiplication of bit-planes by a constant.
+template <typename T, uint8_t K, uint32_t... O>
+static inline void mul_const(const T *in, T *out, std::integer_sequence<uint32_t, O...>)
+{
+    ((out[O] = mul_bit<T, K, O>(in, std::make_integer_sequence<uint32_t, 8>())), ...);
+}
+
+/// Step of the division by the generator polynomial for the coefficient J.
+template <typename T, uint32_t J>
+static inline void lfsr_coef(T (*reg)[8], const T *fb)
+{
+    T m[8];
+    mul_const<T, s_gen[J]>(fb, m, std::make_integer_sequence<uint32_t, 8>());
+    for (uint32_t b = 0; b < 8; b++)
+    {
+        if constexpr (J < 15)
+            reg[J][b] = reg[J + 1][b] ^ m[b];
+        else
+            reg[J][b] = m[b];
+    }
+}
+
+/// Step of the division by the generator polynomial (LFSR).
+template <typename T, uint32_t... J>
+static inline void lfsr_step(T (*reg)[8], const T *fb, std::integer_sequence<uint32_t, J...>)
+{
+    (lfsr_coef<T, J>(reg, fb), ...);
+}
+
+/// Horner step of the syndrome S(J+1): s = s * alfa^(J+1) + x.
+template <typename T, uint32_t J>
+static inline void syndrome_coef(T (*s)[8], const T *x)
+{
+    T m[8];
+    mul_const<T, gf_alfa(J + 1)>(s[J], m, std::make_integer_sequence<uint32_t, 8>());
+    for (uint32_t b = 0; b < 8; b++)
+        s[J][b] = m[b] ^ x[b];
+}
+
+/// Horner step of all syndromes.
+template <typename T, uint32_t... J>
+static inline void syndrome_step(T (*s)[8], const T *x, std::integer_sequence<uint32_t, J...>)
+{
+    (syndrome_coef<T, J>(s, x), ...);
+}
+
+/// Transpose of an 8x8 bit matrix (byte j, bit k -> byte k, bit j).
+static inline uint64_t transpose8(uint64_t x)
+{
+    x = (x & 0xAA55AA55AA55AA55ULL) | ((x & 0x00AA00AA00AA00AAULL) << 7) | ((x >> 7) & 0x00AA00AA00AA00AAULL);
+    x = (x & 0xCCCC3333CCCC3333ULL) | ((x & 0x0000CCCC0000CCCCULL) << 14) | ((x >> 14) & 0x0000CCCC0000CCCCULL);
+    x = (x & 0xF0F0F0F00F0F0F0FULL) | ((x & 0x00000000F0F0F0F0ULL) << 28) | ((x >> 28) & 0x00000000F0F0F0F0ULL);
+    return x;
+}
+
+template <typename T>
+void RSBitSlice<T>::transpose(uint8_t *data, uint32_t stride, uint32_t size, uint32_t count, T (*planes)[8])
+{
+    assert(data != nullptr);
+    assert(planes != nullptr);
+    assert(count <= WIDTH);
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        T p[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        // Groups of 8 codewords
+        for (uint32_t g = 0; g < count; g += 8)
+        {
+            uint64_t x = 0;
+            for (uint32_t j = 0; (j < 8) && ((g + j) < count); j++)
+                x |= (uint64_t)data[(g + j) * stride + i] << (8 * j);
+            x = transpose8(x);
+            for (uint32_t b = 0; b < 8; b++)
+                p[b] |= (T)((x >> (8 * b)) & 0xFF) << g;
+        }
+        std::memcpy(planes[i], p, sizeof(p));
+    }
+}
+
+template <typename T>
+void RSBitSlice<T>::untranspose(T (*planes)[8], uint32_t size, uint32_t count, uint8_t *data, uint32_t stride)
+{
+    assert(planes != nullptr);
+    assert(data != nullptr);
+    assert(count <= WIDTH);
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        // Groups of 8 codewords
+        for (uint32_t g = 0; g < count; g += 8)
+        {
+            uint64_t x = 0;
+            for (uint32_t b = 0; b < 8; b++)
+                x |= (uint64_t)((planes[i][b] >> g) & 0xFF) << (8 * b);
+            x = transpose8(x);
+            for (uint32_t j = 0; (j < 8) && ((g + j) < count); j++)
+                data[(g + j) * stride + i] = (x >> (8 * j)) & 0xFF;
+        }
+    }
+}
+
+template <typename T>
+#ifdef CONFIG_RS_IN_RAM
+void IRAM_ATTR RSBitSlice<T>::encode(T (*planes)[8], uint32_t size)
+#else
+void RSBitSlice<T>::encode(T (*planes)[8], uint32_t size)
+#endif
+{
+    assert(planes != nullptr);
+    assert(size > 0);
+
+    // Division of the messages by the generator polynomial (LFSR)
+    T reg[16][8];
+    std::memset(reg, 0, sizeof(reg));
+    for (uint32_t i = 0; i < size; i++)
+    {
+        T fb[8];
+        for (uint32_t b = 0; b < 8; b++)
+            fb[b] = planes[i][b] ^ reg[0][b];
+        lfsr_step<T>(reg, fb, std::make_integer_sequence<uint32_t, 16>());
+    }
+    std::memcpy(planes[size], reg, sizeof(reg));
+}
+
+template <typename T>
+#ifdef CONFIG_RS_IN_RAM
+T IRAM_ATTR RSBitSlice<T>::check(T (*planes)[8], uint32_t size, T (*syndromes)[8])
+#else
+T RSBitSlice<T>::check(T (*planes)[8], uint32_t size, T (*syndromes)[8])
+#endif
+{
+    assert(planes != nullptr);
+    assert(size > 0);
+
+    // Syndromes S[i] = codeword(alfa^(i+1)) by Horner's method
+    T s[16][8];
+    std::memset(s, 0, sizeof(s));
+    for (uint32_t i = 0; i < (size + 16); i++)
+        syndrome_step<T>(s, planes[i], std::make_integer_sequence<uint32_t, 16>());
+
+    T mask = 0;
+    for (uint32_t j = 0; j < 16; j++)
+    {
+        for (uint32_t b = 0; b < 8; b++)
+            mask |= s[j][b];
+    }
+    if (syndromes != nullptr)
+        std::memcpy(syndromes, s, sizeof(s));
+    return mask;
+}
+
+template class RSBitSlice<uint32_t>;
+template class RSBitSlice<uint64_t>;
\ No newline at end of file
@@ -12,6 +12,117 @@
 #include "esp_attr.h"
 #include "esp_log.h"
 
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "CRC32 word processing expects little-endian CPU");
+
+/// Slice-by-4 CRC32 tables (polynomial 0xEDB88320, as esp_crc32_le()).
+struct CrcTables
+{
+    uint32_t t[4][256];
+};
+
+/// Generation of the CRC32 tables at compile time.
+static constexpr CrcTables crc_tables_make()
+{
+    CrcTables res{};
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t c = i;
+        for (uint32_t k = 0; k < 8; k++)
+            c = (c & 1) ? ((c >> 1) ^ 0xEDB88320) : (c >> 1);
+        res.t[0][i] = c;
+    }
+    for (uint32_t k = 1; k < 4; k++)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+            res.t[k][i] = (res.t[k - 1][i] >> 8) ^ res.t[0][res.t[k - 1][i] & 0xFF];
+    }
+    return res;
+}
+
+/// CRC32 tables.
+#ifdef CONFIG_RS_IN_RAM
+DRAM_ATTR
+#endif // CONFIG_RS_IN_RAM
+static const CrcTables s_crc = crc_tables_make();
+
+/// CRC32 update by 4 bytes (slice-by-4).
+static inline uint32_t crc32_word(uint32_t crc, uint32_t w)
+{
+    crc ^= w;
+    return s_crc.t[3][crc & 0xFF] ^ s_crc.t[2][(crc >> 8) & 0xFF] ^ s_crc.t[1][(crc >> 16) & 0xFF] ^ s_crc.t[0][crc >> 24];
+}
+
+/// CRC32 update by 1 byte.
+static inline uint32_t crc32_byte(uint32_t crc, uint8_t x)
+{
+    return (crc >> 8) ^ s_crc.t[0][(crc ^ x) & 0xFF];
+}
+
+/// CRC32 update (without the initial and final inversion).
+#ifdef CONFIG_RS_IN_RAM
+static uint32_t IRAM_ATTR crc32_update(uint32_t crc, uint8_t *data, uint32_t size)
+#else
+static uint32_t crc32_update(uint32_t crc, uint8_t *data, uint32_t size)
+#endif
+{
+    uint32_t i = 0;
+    for (; (i + 4) <= size; i += 4)
+    {
+        uint32_t w;
+        std::memcpy(&w, &data[i], 4);
+        crc = crc32_word(crc, w);
+    }
+    for (; i < size; i++)
+        crc = crc32_byte(crc, data[i]);
+    return crc;
+}
+
+#if CONFIG_RS_ENCODER_SLICE > 1
+/// Parity contributions of 4 message bytes.
+static inline void slice_word(const uint32_t (*tab)[256][4], uint32_t *reg, uint32_t v)
+{
+    const uint32_t *t0 = tab[0][v & 0xFF];
+    const uint32_t *t1 = tab[1][(v >> 8) & 0xFF];
+    const uint32_t *t2 = tab[2][(v >> 16) & 0xFF];
+    const uint32_t *t3 = tab[3][v >> 24];
+    for (uint32_t j = 0; j < 4; j++)
+        reg[j] ^= t0[j] ^ t1[j] ^ t2[j] ^ t3[j];
+}
+
+/// Division step by a block of CONFIG_RS_ENCODER_SLICE message bytes.
+static inline void slice_block(const uint32_t (*tab)[256][4], uint32_t *reg, const uint32_t *w)
+{
+    // Leading bytes of the remainder are added to the block and shifted out
+#if CONFIG_RS_ENCODER_SLICE == 8
+    uint32_t v0 = w[0] ^ reg[0];
+    uint32_t v1 = w[1] ^ reg[1];
+    reg[0] = reg[2];
+    reg[1] = reg[3];
+    reg[2] = 0;
+    reg[3] = 0;
+    slice_word(tab, reg, v0);
+    slice_word(&tab[4], reg, v1);
+#else
+    uint32_t v = w[0] ^ reg[0];
+    reg[0] = reg[1];
+    reg[1] = reg[2];
+    reg[2] = reg[3];
+    reg[3] = 0;
+    slice_word(tab, reg, v);
+#endif
+}
+
+/// Division step by one message byte.
+static inline void slice_byte(const uint32_t (*tab)[256][4], uint32_t *reg, uint8_t x)
+{
+    const uint32_t *t = tab[CONFIG_RS_ENCODER_SLICE - 1][x ^ (reg[0] & 0xFF)];
+    reg[0] = (reg[0] >> 8) ^ (reg[1] << 24) ^ t[0];
+    reg[1] = (reg[1] >> 8) ^ (reg[2] << 24) ^ t[1];
+    reg[2] = (reg[2] >> 8) ^ (reg[3] << 24) ^ t[2];
+    reg[3] = (reg[3] >> 8) ^ t[3];
+}
+#endif // CONFIG_RS_ENCODER_SLICE
+
 #ifdef CONFIG_RS_IN_RAM
 void IRAM_ATTR RSEncode16::poly_remainder(uint8_t *data, uint8_t *data_mod, uint32_t size)
 #else
@@ -23,6 +134,24 @@ void RSEncode16::poly_remainder(uint8_t *data, uint8_t *data_mod, uint32_t size)
     assert(data_mod != nullptr);
     assert(size > 16);
 
+#if CONFIG_RS_ENCODER_SLICE > 1
+    // Divide the message by the generator polynomial, CONFIG_RS_ENCODER_SLICE bytes per step
+    uint32_t reg[4] = {0, 0, 0, 0};
+    uint32_t i = 0;
+    for (; (i + CONFIG_RS_ENCODER_SLICE) <= size; i += CONFIG_RS_ENCODER_SLICE)
+    {
+        uint32_t w[CONFIG_RS_ENCODER_SLICE / 4];
+        std::memcpy(w, &data[i], sizeof(w));
+        slice_block(gslice, reg, w);
+    }
+    for (; i < size; i++)
+        slice_byte(gslice, reg, data[i]);
+
+    // Remainder of the whole polynomial: remainder of the message + last 16 coefficients
+    std::memcpy(data_mod, reg, 16);
+    for (uint32_t j = 0; j < 16; j++)
+        data_mod[j] ^= data[size + j];
+#else
     // Calculate the polynomial remainder using the generator polynomial m_G
     // This is essentially polynomial division in GF(2^8) to find the syndrome polynomial coefficients
     uint8_t x = data[0]; // Leading coefficient for the first iteration
@@ -30,7 +159,11 @@ void RSEncode16::poly_remainder(uint8_t *data, uint8_t *data_mod, uint32_t size)
     {
         // Multiply the leading coefficient 'x' with the generator polynomial coefficient m_G[j]
         // and XOR the result with the corresponding data coefficient
+#ifdef CONFIG_RS_TABLES_RUNTIME
+        data_mod[j] = data[j + 1] ^ gmulG[x][j];
+#else
         data_mod[j] = data[j + 1] ^ gmul[x][m_G[j]];
+#endif
     }
 
     // Continue the polynomial division process for the remaining coefficients
@@ -40,17 +173,26 @@ void RSEncode16::poly_remainder(uint8_t *data, uint8_t *data_mod, uint32_t size)
         // Shift the remainder coefficients left and update them
         for (uint32_t j = 0; j < 15; j++)
         {
+#ifdef CONFIG_RS_TABLES_RUNTIME
+            data_mod[j] = data_mod[j + 1] ^ gmulG[x][j];
+#else
             data_mod[j] = data_mod[j + 1] ^ gmul[x][m_G[j]];
+#endif
         }
         // Handle the last coefficient separately
+#ifdef CONFIG_RS_TABLES_RUNTIME
+        data_mod[15] = data[i + 16] ^ gmulG[x][15];
+#else
         data_mod[15] = data[i + 16] ^ gmul[x][m_G[15]];
+#endif
     }
+#endif // CONFIG_RS_ENCODER_SLICE
 }
 
 #ifdef CONFIG_RS_IN_RAM
-void IRAM_ATTR RSEncode16::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
+bool IRAM_ATTR RSEncode16::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
 #else
-void RSEncode16::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
+bool RSEncode16::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
 #endif
 {
     // Assert that input pointers are valid and size is positive
@@ -58,6 +200,12 @@ void RSEncode16::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
     assert(data_out != nullptr);
     assert(size > 0);
 
+#ifdef CONFIG_RS_TABLES_RUNTIME
+    // Generate the encoder tables on the first call
+    if (!initTables(false))
+        return false;
+#endif
+
     // Copy the input data to the output buffer if they are different
     if (data_in != data_out)
         std::memcpy(data_out, data_in, size);
@@ -71,6 +219,7 @@ void RSEncode16::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
     poly_remainder(data_out, tmp, size);
     // Copy the calculated remainder (the parity bytes) into the output buffer after the message data
     std::memcpy(&data_out[size], tmp, 16);
+    return true;
 }
 
 #ifdef CONFIG_RS_IN_RAM
@@ -118,9 +267,9 @@ uint8_t RSEncode16::poly_eval2(uint8_t data, uint8_t *data_poly, uint32_t size)
 }
 
 #ifdef CONFIG_RS_IN_RAM
-void IRAM_ATTR RSEncode16::decode(uint8_t *data_in, uint8_t *data_out, uint32_t size)
+bool IRAM_ATTR RSEncode16::decode(uint8_t *data_in, uint8_t *data_out, uint32_t size)
 #else
-void RSEncode16::decode(uint8_t *data_in, uint8_t *data_out, uint32_t size)
+bool RSEncode16::decode(uint8_t *data_in, uint8_t *data_out, uint32_t size)
 #endif
 {
     // Assert that input pointers are valid and size is positive
@@ -132,16 +281,38 @@ void RSEncode16::decode(uint8_t *data_in, uint8_t *data_out, uint32_t size)
     if (data_in != data_out)
         std::memcpy(data_out, data_in, size);
 
+#ifdef CONFIG_RS_TABLES_RUNTIME
+    // Generate all tables on the first call, without them the data is not corrected
+    if (!initTables(true))
+        return false;
+#endif
+
     // Calculate the polynomial remainder (syndrome polynomial coefficients) for the received data
     uint8_t tmp[16];
     poly_remainder(data_in, tmp, size);
 
+    // Correct the data using the remainder
+    correct(tmp, data_out, size);
+    return true;
+}
+
+#ifdef CONFIG_RS_IN_RAM
+void IRAM_ATTR RSEncode16::correct(uint8_t *rem, uint8_t *data_out, uint32_t size)
+#else
+void RSEncode16::correct(uint8_t *rem, uint8_t *data_out, uint32_t size)
+#endif
+{
+    // Assert that input pointers are valid and size is positive
+    assert(rem != nullptr);
+    assert(data_out != nullptr);
+    assert(size > 0);
+
     // Calculate syndromes S[i] = syndrome_poly(galfa[i+1]) for i = 0 to 15
     uint8_t s[16];
     uint8_t flag = 0; // Flag to indicate if any syndrome is non-zero (errors detected)
     for (uint8_t i = 0; i < 16; i++)
     {
-        s[i] = poly_eval(i + 1, tmp, 16); // Evaluate syndrome polynomial at galfa[i+1]
+        s[i] = poly_eval(i + 1, rem, 16); // Evaluate syndrome polynomial at galfa[i+1]
         if (s[i] != 0)
             flag = 1; // Set flag if any syndrome is non-zero
     }
@@ -302,4 +473,141 @@ void RSEncode16::poly_mul(uint8_t *p1, uint32_t p1_size, uint8_t *p2, uint32_t p
             result[n1 + n2] ^= gmul[p1[n1]][p2[n2]];
         }
     }
+}
+
+#ifdef CONFIG_RS_IN_RAM
+uint32_t IRAM_ATTR RSEncode16::crc_parity(uint8_t *data_in, uint32_t size, uint8_t *data_out, uint8_t *reg, uint32_t crc)
+#else
+uint32_t RSEncode16::crc_parity(uint8_t *data_in, uint32_t size, uint8_t *data_out, uint8_t *reg, uint32_t crc)
+#endif
+{
+#if CONFIG_RS_ENCODER_SLICE > 1
+    // Each input block is read once: CRC, copy and parity
+    uint32_t r[4];
+    std::memcpy(r, reg, 16);
+    uint32_t i = 0;
+    for (; (i + CONFIG_RS_ENCODER_SLICE) <= size; i += CONFIG_RS_ENCODER_SLICE)
+    {
+        uint32_t w[CONFIG_RS_ENCODER_SLICE / 4];
+        std::memcpy(w, &data_in[i], sizeof(w));
+        std::memcpy(&data_out[i], w, sizeof(w));
+        for (uint32_t k = 0; k < (CONFIG_RS_ENCODER_SLICE / 4); k++)
+            crc = crc32_word(crc, w[k]);
+        slice_block(gslice, r, w);
+    }
+    // Tail bytes
+    for (; i < size; i++)
+    {
+        uint8_t x = data_in[i];
+        data_out[i] = x;
+        crc = crc32_byte(crc, x);
+        slice_byte(gslice, r, x);
+    }
+    std::memcpy(reg, r, 16);
+    return crc;
+#else
+    // One step of the division by the generator polynomial (LFSR form of poly_remainder())
+    auto step = [reg](uint8_t x)
+    {
+        uint8_t fb = x ^ reg[0]; // Feedback: input byte + leading coefficient of the remainder
+#ifdef CONFIG_RS_TABLES_RUNTIME
+        const uint8_t *g = gmulG[fb];
+        for (uint32_t j = 0; j < 15; j++)
+            reg[j] = reg[j + 1] ^ g[j];
+        reg[15] = g[15];
+#else
+        const uint8_t *g = gmul[fb];
+        for (uint32_t j = 0; j < 15; j++)
+            reg[j] = reg[j + 1] ^ g[m_G[j]];
+        reg[15] = g[m_G[15]];
+#endif
+    };
+
+    // Each input word is read once: CRC, copy and parity
+    uint32_t i = 0;
+    for (; (i + 4) <= size; i += 4)
+    {
+        uint32_t w;
+        std::memcpy(&w, &data_in[i], 4);
+        std::memcpy(&data_out[i], &w, 4);
+        crc = crc32_word(crc, w);
+        step(w & 0xFF);
+        step((w >> 8) & 0xFF);
+        step((w >> 16) & 0xFF);
+        step(w >> 24);
+    }
+    // Tail bytes
+    for (; i < size; i++)
+    {
+        uint8_t x = data_in[i];
+        data_out[i] = x;
+        crc = crc32_byte(crc, x);
+        step(x);
+    }
+    return crc;
+#endif // CONFIG_RS_ENCODER_SLICE
+}
+
+#ifdef CONFIG_RS_IN_RAM
+bool IRAM_ATTR RSEncode16::encode_with_crc(uint8_t *data_in, uint32_t size, uint8_t *data_out, uint32_t *crc)
+#else
+bool RSEncode16::encode_with_crc(uint8_t *data_in, uint32_t size, uint8_t *data_out, uint32_t *crc)
+#endif
+{
+    // Assert that input pointers are valid and size is positive
+    assert(data_in != nullptr);
+    assert(data_out != nullptr);
+    assert(crc != nullptr);
+    assert(size > 0);
+
+#ifdef CONFIG_RS_TABLES_RUNTIME
+    // Generate the encoder tables on the first call
+    if (!initTables(false))
+        return false;
+#endif
+
+    // Parity bytes are the remainder of the message shifted by 16 bytes
+    uint8_t reg[16];
+    std::memset(reg, 0, 16);
+    *crc = ~crc_parity(data_in, size, data_out, reg, ~(*crc));
+    std::memcpy(&data_out[size], reg, 16);
+    return true;
+}
+
+#ifdef CONFIG_RS_IN_RAM
+bool IRAM_ATTR RSEncode16::decode_with_crc(uint8_t *data_in, uint8_t *data_out, uint32_t size, uint32_t crc, uint32_t init)
+#else
+bool RSEncode16::decode_with_crc(uint8_t *data_in, uint8_t *data_out, uint32_t size, uint32_t crc, uint32_t init)
+#endif
+{
+    // Assert that input pointers are valid and size is positive
+    assert(data_in != nullptr);
+    assert(data_out != nullptr);
+    assert(size > 0);
+
+#ifdef CONFIG_RS_TABLES_RUNTIME
+    // Generate all tables on the first call
+    if (!initTables(true))
+        return false;
+#endif
+
+    // Copy, CRC and parity of the received message in one pass
+    uint8_t rem[16];
+    std::memset(rem, 0, 16);
+    uint32_t res = ~crc_parity(data_in, size, data_out, rem, ~init);
+
+    // Remainder of the received codeword: parity of the message + received parity
+    uint8_t flag = 0;
+    for (uint32_t j = 0; j < 16; j++)
+    {
+        rem[j] ^= data_in[size + j];
+        flag |= rem[j];
+    }
+    if (flag != 0)
+    {
+        // Errors detected: correct the data and recalculate CRC
+        correct(rem, data_out, size);
+        res = ~crc32_update(~init, data_out, size);
+    }
+    return res == crc;
 }
\ No newline at end of file
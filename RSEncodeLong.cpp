@@ -0,0 +1,400 @@
+/*!
+    \file
+    \brief Class for implementing Reed-Solomon encoding over GF(2^16).
+    \authors Bliznets R.A. (r.bliznets@gmail.com)
+    \version 1.0.1.0
+    \date 18.10.2026
+*/
+
+#include "RSEncodeLong.h"
+#include <cstring>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "rs_tables.h"
+
+#define RS_LONG_POLY 0x1100B ///< Field polynomial x^16 + x^12 + x^3 + x + 1.
+#define RS_LONG_N 65535      ///< Multiplicative group order.
+
+uint16_t *RSEncodeLong::glog = nullptr;
+uint16_t *RSEncodeLong::gexp = nullptr;
+
+static std::atomic<uint8_t> s_state(TABLES_NONE); ///< State of the tables.
+
+#if defined(CONFIG_RS_LONG_TABLES_MEMORY_SPIRAM)
+/// Memory for the tables.
+static RSTablesMemory s_memory = {nullptr, 0, nullptr, 0, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT};
+#elif defined(CONFIG_RS_LONG_TABLES_MEMORY_STATIC)
+/// Static arena for the tables in PSRAM.
+EXT_RAM_BSS_ATTR static uint8_t s_arena[RSEncodeLong::TABLES_SIZE] __attribute__((aligned(4)));
+/// Memory for the tables.
+static RSTablesMemory s_memory = {nullptr, 0, s_arena, sizeof(s_arena), 0};
+#else
+/// Memory for the tables (only setTableMemory()).
+static RSTablesMemory s_memory = {nullptr, 0, nullptr, 0, 0};
+#endif
+
+/// Multiplication in GF(65536) without tables.
+static uint16_t gf16_mul(uint16_t a, uint16_t b)
+{
+    uint32_t x = a;
+    uint16_t res = 0;
+    while (b != 0)
+    {
+        if (b & 1)
+            res ^= x;
+        x <<= 1;
+        if (x & 0x10000)
+            x ^= RS_LONG_POLY;
+        b >>= 1;
+    }
+    return res;
+}
+
+/// Generation of the tables.
+/*!
+    \param[out] log pointer to the logarithm table (65536 entries).
+    \param[out] exp pointer to the power table (65536 entries).
+    \return true if the tables are correct.
+*/
+static bool tables_fill(uint16_t *log, uint16_t *exp)
+{
+    uint32_t x = 1;
+    for (uint32_t i = 0; i < RS_LONG_N; i++)
+    {
+        if ((i != 0) && (x == 1))
+            return false; // Polynomial is not primitive
+        exp[i] = x;
+        log[x] = i;
+        x <<= 1;
+        if (x & 0x10000)
+            x ^= RS_LONG_POLY;
+    }
+    exp[RS_LONG_N] = 1;
+    log[0] = 0;
+    if (x != 1)
+        return false;
+
+    // Self-check: known powers and products by the tables against the bitwise multiplication
+    if ((exp[16] != (RS_LONG_POLY & 0xFFFF)) || (exp[15] != 0x8000))
+        return false;
+    for (uint32_t a = 1; a < 0x10000; a += 0x0FED)
+    {
+        for (uint32_t b = 3; b < 0x10000; b += 0x1357)
+        {
+            uint32_t k = log[a] + log[b];
+            if (exp[(k < RS_LONG_N) ? k : (k - RS_LONG_N)] != gf16_mul(a, b))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool RSEncodeLong::setTableMemory(void *mem, uint32_t size)
+{
+    if ((mem == nullptr) || (size < TABLES_SIZE) || (((uintptr_t)mem & 1) != 0))
+        return false;
+    if (s_state.load() != TABLES_NONE)
+        return false; // Tables are already generated
+
+    s_memory.mem = (uint8_t *)mem;
+    s_memory.mem_size = size;
+    return true;
+}
+
+bool RSEncodeLong::buildTables()
+{
+    uint16_t *mem = (uint16_t *)rs_tables_alloc(s_memory, 0, TABLES_SIZE);
+    if (mem == nullptr)
+    {
+        ESP_LOGE("RSEncodeLong", "no memory for the tables");
+        return false;
+    }
+    if (!tables_fill(mem, &mem[65536]))
+    {
+        ESP_LOGE("RSEncodeLong", "tables check failed");
+        rs_tables_free(s_memory, (uint8_t *)mem);
+        return false;
+    }
+
+    glog = mem;
+    gexp = &mem[65536];
+    return true;
+}
+
+bool RSEncodeLong::initTables()
+{
+    return rs_tables_build(s_state, buildTables);
+}
+
+RSEncodeLong::RSEncodeLong(uint16_t parity)
+{
+    assert(parity >= 2);
+    assert(parity <= CONFIG_RS_LONG_MAX_PARITY);
+    m_parity = parity;
+
+    // Generator polynomial G(x) = (x + alfa^1)...(x + alfa^parity), highest degree first
+    uint16_t g[CONFIG_RS_LONG_MAX_PARITY + 1];
+    std::memset(g, 0, sizeof(g));
+    g[0] = 1;
+    uint16_t alfa = 1;
+    for (uint32_t i = 1; i <= m_parity; i++)
+    {
+        alfa = gf16_mul(alfa, 2);
+        for (uint32_t k = i; k > 0; k--)
+            g[k] ^= gf16_mul(alfa, g[k - 1]);
+    }
+    std::memcpy(m_G, &g[1], m_parity * sizeof(uint16_t));
+}
+
+inline uint16_t RSEncodeLong::gf_mul(uint16_t a, uint16_t b)
+{
+    if ((a == 0) || (b == 0))
+        return 0;
+    uint32_t k = glog[a] + glog[b];
+    return gexp[(k < RS_LONG_N) ? k : (k - RS_LONG_N)];
+}
+
+#ifdef CONFIG_RS_IN_RAM
+void IRAM_ATTR RSEncodeLong::poly_remainder(uint8_t *data, uint32_t count, uint16_t *reg)
+#else
+void RSEncodeLong::poly_remainder(uint8_t *data, uint32_t count, uint16_t *reg)
+#endif
+{
+    assert(data != nullptr);
+    assert(reg != nullptr);
+
+    // Logarithms of the generator polynomial coefficients (RS_LONG_N for zero)
+    uint16_t lg[CONFIG_RS_LONG_MAX_PARITY];
+    for (uint32_t j = 0; j < m_parity; j++)
+        lg[j] = (m_G[j] != 0) ? glog[m_G[j]] : RS_LONG_N;
+
+    // Division by the generator polynomial (LFSR), one symbol per step
+    std::memset(reg, 0, m_parity * sizeof(uint16_t));
+    const uint32_t last = m_parity - 1;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint16_t fb = ((data[2 * i] << 8) | data[2 * i + 1]) ^ reg[0];
+        if (fb == 0)
+        {
+            std::memmove(reg, &reg[1], last * sizeof(uint16_t));
+            reg[last] = 0;
+            continue;
+        }
+        uint32_t lf = glog[fb];
+        for (uint32_t j = 0; j < last; j++)
+        {
+            uint16_t x = reg[j + 1];
+            if (lg[j] != RS_LONG_N)
+            {
+                uint32_t k = lf + lg[j];
+                x ^= gexp[(k < RS_LONG_N) ? k : (k - RS_LONG_N)];
+            }
+            reg[j] = x;
+        }
+        if (lg[last] != RS_LONG_N)
+        {
+            uint32_t k = lf + lg[last];
+            reg[last] = gexp[(k < RS_LONG_N) ? k : (k - RS_LONG_N)];
+        }
+        else
+        {
+            reg[last] = 0;
+        }
+    }
+}
+
+#ifdef CONFIG_RS_IN_RAM
+bool IRAM_ATTR RSEncodeLong::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
+#else
+bool RSEncodeLong::encode(uint8_t *data_in, uint32_t size, uint8_t *data_out)
+#endif
+{
+    // Assert that input pointers are valid and size is an even number of bytes
+    assert(data_in != nullptr);
+    assert(data_out != nullptr);
+    assert(size > 0);
+    assert((size & 1) == 0);
+    assert((size / 2 + m_parity) <= RS_LONG_N);
+
+    // Generate the tables on the first call
+    if (!initTables())
+        return false;
+
+    // Copy the input data to the output buffer if they are different
+    if (data_in != data_out)
+        std::memcpy(data_out, data_in, size);
+
+    // Parity symbols are the remainder of the message shifted by parity symbols
+    uint16_t reg[CONFIG_RS_LONG_MAX_PARITY];
+    poly_remainder(data_in, size / 2, reg);
+    for (uint32_t j = 0; j < m_parity; j++)
+    {
+        data_out[size + 2 * j] = reg[j] >> 8;
+        data_out[size + 2 * j + 1] = reg[j] & 0xFF;
+    }
+    return true;
+}
+
+#ifdef CONFIG_RS_IN_RAM
+int IRAM_ATTR RSEncodeLong::decode(uint8_t *data_in, uint8_t *data_out, uint32_t size)
+#else
+int RSEncodeLong::decode(uint8_t *data_in, uint8_t *data_out, uint32_t size)
+#endif
+{
+    // Assert that input pointers are valid and size is an even number of bytes
+    assert(data_in != nullptr);
+    assert(data_out != nullptr);
+    assert(size > 0);
+    assert((size & 1) == 0);
+    assert((size / 2 + m_parity) <= RS_LONG_N);
+
+    // Generate the tables on the first call
+    if (!initTables())
+        return -1;
+
+    // Copy the input data (potentially corrupted) to the output buffer if they are different
+    if (data_in != data_out)
+        std::memcpy(data_out, data_in, size);
+
+    // Remainder of the received codeword: remainder of the message + received parity
+    const uint32_t count = size / 2;
+    const uint32_t n = count + m_parity;
+    uint16_t rem[CONFIG_RS_LONG_MAX_PARITY];
+    poly_remainder(data_in, count, rem);
+    uint16_t flag = 0;
+    for (uint32_t j = 0; j < m_parity; j++)
+    {
+        rem[j] ^= (data_in[size + 2 * j] << 8) | data_in[size + 2 * j + 1];
+        flag |= rem[j];
+    }
+    if (flag == 0) // No errors
+        return 0;
+
+    // Syndromes S[i] = rem(alfa^(i+1)) from the short remainder polynomial
+    uint16_t s[CONFIG_RS_LONG_MAX_PARITY];
+    for (uint32_t i = 0; i < m_parity; i++)
+    {
+        uint16_t x = 0;
+        for (uint32_t j = 0; j < m_parity; j++)
+        {
+            if (x != 0)
+            {
+                uint32_t k = glog[x] + i + 1;
+                x = gexp[(k < RS_LONG_N) ? k : (k - RS_LONG_N)];
+            }
+            x ^= rem[j];
+        }
+        s[i] = x;
+    }
+
+    // Berlekamp-Massey algorithm: error locator polynomial lambda (lowest degree first)
+    uint16_t lambda[CONFIG_RS_LONG_MAX_PARITY + 1];
+    uint16_t prev[CONFIG_RS_LONG_MAX_PARITY + 1];
+    uint16_t tmp[CONFIG_RS_LONG_MAX_PARITY + 1];
+    std::memset(lambda, 0, sizeof(lambda));
+    std::memset(prev, 0, sizeof(prev));
+    lambda[0] = 1;
+    prev[0] = 1;
+    uint32_t len = 0;   // Number of errors
+    uint32_t shift = 1; // Shift of the previous polynomial
+    uint16_t b = 1;     // Previous discrepancy
+    for (uint32_t r = 0; r < m_parity; r++)
+    {
+        uint16_t delta = s[r];
+        for (uint32_t k = 1; k <= len; k++)
+            delta ^= gf_mul(lambda[k], s[r - k]);
+        if (delta == 0)
+        {
+            shift++;
+            continue;
+        }
+
+        // lambda = lambda - delta/b * x^shift * prev
+        uint32_t lc = glog[delta] + RS_LONG_N - glog[b];
+        if (lc >= RS_LONG_N)
+            lc -= RS_LONG_N;
+        std::memcpy(tmp, lambda, sizeof(lambda));
+        for (uint32_t k = 0; (k + shift) <= m_parity; k++)
+        {
+            if (prev[k] != 0)
+            {
+                uint32_t kk = glog[prev[k]] + lc;
+                lambda[k + shift] ^= gexp[(kk < RS_LONG_N) ? kk : (kk - RS_LONG_N)];
+            }
+        }
+        if ((2 * len) <= r)
+        {
+            len = r + 1 - len;
+            std::memcpy(prev, tmp, sizeof(prev));
+            b = delta;
+            shift = 1;
+        }
+        else
+        {
+            shift++;
+        }
+    }
+    if ((2 * len) > m_parity)
+        return -1; // Too many errors
+
+    // Chien search over the codeword positions only: lambda(alfa^-e), e = n - 1 - position
+    uint16_t lt[CONFIG_RS_LONG_MAX_PARITY + 1]; // Logarithms of the terms (RS_LONG_N for zero)
+    for (uint32_t k = 1; k <= len; k++)
+        lt[k] = (lambda[k] != 0) ? glog[lambda[k]] : RS_LONG_N;
+    uint32_t pos[CONFIG_RS_LONG_MAX_PARITY / 2]; // Error positions (e)
+    uint32_t found = 0;
+    for (uint32_t e = 0; (e < n) && (found < len); e++)
+    {
+        uint16_t x = lambda[0];
+        for (uint32_t k = 1; k <= len; k++)
+        {
+            if (lt[k] != RS_LONG_N)
+            {
+                x ^= gexp[lt[k]];
+                // Next position: term * alfa^-k
+                lt[k] = (lt[k] >= k) ? (lt[k] - k) : (lt[k] + RS_LONG_N - k);
+            }
+        }
+        if (x == 0)
+            pos[found++] = e;
+    }
+    if (found != len)
+        return -1; // Roots are not in the codeword
+
+    // Error evaluator polynomial omega = S * lambda mod x^len
+    uint16_t omega[CONFIG_RS_LONG_MAX_PARITY / 2];
+    for (uint32_t k = 0; k < len; k++)
+    {
+        omega[k] = 0;
+        for (uint32_t i = 0; i <= k; i++)
+            omega[k] ^= gf_mul(lambda[i], s[k - i]);
+    }
+
+    // Forney algorithm: error value = omega(X^-1) / lambda'(X^-1)
+    for (uint32_t l = 0; l < found; l++)
+    {
+        uint32_t e = pos[l];
+        uint16_t xinv = gexp[(e == 0) ? 0 : (RS_LONG_N - e)];
+        uint16_t num = 0;
+        for (uint32_t k = len; k > 0; k--)
+            num = gf_mul(num, xinv) ^ omega[k - 1];
+        uint16_t den = 0;
+        uint16_t xinv2 = gf_mul(xinv, xinv);
+        for (int32_t k = (len & 1) ? len : (len - 1); k > 0; k -= 2)
+            den = gf_mul(den, xinv2) ^ lambda[k];
+        if (den == 0)
+            return -1;
+
+        uint32_t i = n - 1 - e; // Symbol index in the codeword
+        if (i < count)
+        {
+            uint32_t k = glog[num] + RS_LONG_N - glog[den];
+            uint16_t y = (num == 0) ? 0 : gexp[(k < RS_LONG_N) ? k : (k - RS_LONG_N)];
+            data_out[2 * i] ^= y >> 8;
+            data_out[2 * i + 1] ^= y & 0xFF;
+        }
+    }
+    return found;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*!
+    \file
+    \brief Bit-sliced Reed-Solomon (n+16,n) encoding of codeword batches.
+    \authors Bliznets R.A. (r.bliznets@gmail.com)
+    \version 1.0.1.0
+    \date 18.10.2026
+*/
+
+#pragma once
+
+#include "sdkconfig.h"
+#include <stdint.h>
+
+/// Bit-sliced Reed-Solomon code class.
+/*!
+    Same code as RSEncode16 (GF(256), D = 17), for batches of 32 (T = uint32_t)
+    or 64 (T = uint64_t) codewords in plain integer registers.
+    Codewords are transposed to bit-planes: bit c of planes[i][b] is bit b of byte i of codeword c.
+    Multiplications by the generator polynomial coefficients and by the powers of alpha
+    are XOR networks generated at compile time, without tables and branches.
+    \tparam T word type (uint32_t or uint64_t).
+ */
+template <typename T>
+class RSBitSlice
+{
+public:
+    static const uint32_t WIDTH = 8 * sizeof(T); ///< Number of codewords in a batch.
+
+    /// Transpose of codewords to bit-planes.
+    /*!
+        \param[in] data pointer to the 1st codeword.
+        \param[in] stride distance between codewords in bytes.
+        \param[in] size size of a codeword.
+        \param[in] count number of codewords (up to WIDTH, missing codewords are zero).
+        \param[out] planes pointer to the bit-planes (size).
+    */
+    static void transpose(uint8_t *data, uint32_t stride, uint32_t size, uint32_t count, T (*planes)[8]);
+    /// Transpose of bit-planes to codewords.
+    /*!
+        \param[in] planes pointer to the bit-planes (size).
+        \param[in] size size of a codeword.
+        \param[in] count number of codewords (up to WIDTH).
+        \param[out] data pointer to the 1st codeword.
+        \param[in] stride distance between codewords in bytes.
+    */
+    static void untranspose(T (*planes)[8], uint32_t size, uint32_t count, uint8_t *data, uint32_t stride);
+
+    /// Encoding.
+    /*!
+        \param[in,out] planes pointer to the bit-planes of the messages (size), parity is written after them (size + 16).
+        \param[in] size size of the messages.
+    */
+    static void encode(T (*planes)[8], uint32_t size);
+    /// Syndrome check.
+    /*!
+        \param[in] planes pointer to the bit-planes of the codewords (size + 16).
+        \param[in] size size of the messages.
+        \param[out] syndromes pointer to the bit-planes of the syndromes S1..S16 (16) or nullptr.
+        \return mask of codewords with errors.
+    */
+    static T check(T (*planes)[8], uint32_t size, T (*syndromes)[8] = nullptr);
+};
\ No newline at end of file
@@ -20,9 +20,23 @@
 class RSEncode16
 {
 protected:
+#ifdef CONFIG_RS_TABLES_RUNTIME
+    static uint8_t *ginv;            ///< Inversion table.
+    static uint8_t *galfa;           ///< Power table.
+    static uint8_t (*gmul)[256];     ///< Multiplication table.
+#if CONFIG_RS_ENCODER_SLICE > 1
+    static uint32_t (*gslice)[256][4]; ///< Slice tables of the encoder.
+#else
+    static uint8_t (*gmulG)[16];     ///< Multiplication by the generator polynomial (gmulG[x][j] = x*m_G[j]).
+#endif
+#else
     static const uint8_t ginv[256];      ///< Inversion table.
     static const uint8_t galfa[255];     ///< Power table.
     static const uint8_t gmul[256][256]; ///< Multiplication table.
+#if CONFIG_RS_ENCODER_SLICE > 1
+    static const uint32_t (*const gslice)[256][4]; ///< Slice tables of the encoder.
+#endif
+#endif // CONFIG_RS_TABLES_RUNTIME
 
     /// Generator polynomial.
     static const uint8_t m_G[16];
@@ -60,20 +74,103 @@ protected:
         \param[in] result_size maximum result size.
     */
     void poly_mul(uint8_t *p1, uint32_t p1_size, uint8_t *p2, uint32_t p2_size, uint8_t *result, uint32_t result_size);
+    /// Error correction.
+    /*!
+        \param[in] rem pointer to the remainder of the received codeword (size 16).
+        \param[in,out] data_out pointer to the received data.
+        \param[in] size size of the data.
+    */
+    void correct(uint8_t *rem, uint8_t *data_out, uint32_t size);
+    /// Copy, CRC32 and parity in one pass over the data.
+    /*!
+        \param[in] data_in pointer to the input data array.
+        \param[in] size size of the input data.
+        \param[out] data_out pointer to the output data array (size of input).
+        \param[in,out] reg pointer to the remainder (size 16).
+        \param[in] crc CRC32 register value.
+        \return CRC32 register value.
+    */
+    uint32_t crc_parity(uint8_t *data_in, uint32_t size, uint8_t *data_out, uint8_t *reg, uint32_t crc);
+
+#ifdef CONFIG_RS_TABLES_RUNTIME
+    /// Generation of the encoder tables.
+    /*!
+        \return true if success.
+    */
+    static bool buildEncoderTables();
+    /// Generation of the decoder tables.
+    /*!
+        \return true if success.
+    */
+    static bool buildDecoderTables();
+#endif // CONFIG_RS_TABLES_RUNTIME
 
 public:
+#ifdef CONFIG_RS_TABLES_RUNTIME
+#if CONFIG_RS_ENCODER_SLICE > 1
+    static const uint32_t TABLES_ENCODER_SIZE = CONFIG_RS_ENCODER_SLICE * 256 * 16; ///< Encoder tables size.
+#else
+    static const uint32_t TABLES_ENCODER_SIZE = 256 * 16;                      ///< Encoder tables size.
+#endif
+    static const uint32_t TABLES_SIZE = TABLES_ENCODER_SIZE + 256 * 256 + 512; ///< All tables size.
+
+    /// Set memory for the generated tables.
+    /*!
+        Must be called before the first encode/decode.
+        \param[in] mem pointer to the memory (internal DRAM, PSRAM or static arena), 4 bytes aligned.
+        \param[in] size size of the memory (TABLES_SIZE or TABLES_ENCODER_SIZE for the encoder only).
+        \return true if success.
+    */
+    static bool setTableMemory(void *mem, uint32_t size);
+    /// Release of the generated tables.
+    /*!
+        Heap memory is freed and the memory of setTableMemory() is forgotten,
+        the next encode/decode generates the tables again.
+        Must not be called while encode/decode run in other tasks.
+    */
+    static void releaseTables();
+    /// Generation of the tables.
+    /*!
+        Called on the first encode/decode. Tables are checked against known vectors.
+        \param[in] decoder true - all tables, false - encoder tables only.
+        \return true if success.
+    */
+    static bool initTables(bool decoder = true);
+#endif // CONFIG_RS_TABLES_RUNTIME
+
     /// Encoding.
     /*!
         \param[in] data_in pointer to the input data array.
         \param[in] size size of the input data.
         \param[out] data_out pointer to the output data array (size of input + 16).
+        \return false if the tables are not available (data_out is not written).
     */
-    void encode(uint8_t *data_in, uint32_t size, uint8_t *data_out);
+    bool encode(uint8_t *data_in, uint32_t size, uint8_t *data_out);
     /// Decoding.
     /*!
         \param[in] data_in pointer to the input data array (size of output + 16).
         \param[out] data_out pointer to the output data array.
         \param[in] size size of the output data.
+        \return false if the tables are not available (data_out is the uncorrected input).
+    */
+    bool decode(uint8_t *data_in, uint8_t *data_out, uint32_t size);
+    /// Encoding with CRC32 in one pass over the data.
+    /*!
+        \param[in] data_in pointer to the input data array.
+        \param[in] size size of the input data.
+        \param[out] data_out pointer to the output data array (size of input + 16).
+        \param[in,out] crc previous CRC32 value (as esp_crc32_le(), 0 for a new frame), CRC32 of the input data on return.
+        \return false if the tables are not available (data_out and crc are not written).
+    */
+    bool encode_with_crc(uint8_t *data_in, uint32_t size, uint8_t *data_out, uint32_t *crc);
+    /// Decoding with CRC32 check in one pass over the data.
+    /*!
+        \param[in] data_in pointer to the input data array (size of output + 16).
+        \param[out] data_out pointer to the output data array.
+        \param[in] size size of the output data.
+        \param[in] crc expected CRC32 of the output data.
+        \param[in] init previous CRC32 value (as in encode_with_crc(), 0 for a new frame).
+        \return true if CRC32 of the decoded data is correct.
     */
-    void decode(uint8_t *data_in, uint8_t *data_out, uint32_t size);
+    bool decode_with_crc(uint8_t *data_in, uint8_t *data_out, uint32_t size, uint32_t crc, uint32_t init = 0);
 };
\ No newline at end of file
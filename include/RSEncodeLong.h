@@ -0,0 +1,96 @@
+/*!
+    \file
+    \brief Class for implementing Reed-Solomon encoding over GF(2^16).
+    \authors Bliznets R.A. (r.bliznets@gmail.com)
+    \version 1.0.1.0
+    \date 18.10.2026
+*/
+
+#pragma once
+
+#include "sdkconfig.h"
+#include <stdint.h>
+
+/// Reed-Solomon code class for long blocks.
+/*!
+    GF(65536), polynomial x^16 + x^12 + x^3 + x + 1.
+    Symbols are 16-bit (big-endian byte pairs), codeword up to 65535 symbols.
+    D = parity + 1.
+    Generator polynomial: G=(x+alfa^1)(x+alfa^2)...(x+alfa^parity).
+ */
+class RSEncodeLong
+{
+protected:
+    static uint16_t *glog; ///< Logarithm table.
+    static uint16_t *gexp; ///< Power table.
+
+    uint16_t m_parity;                        ///< Number of parity symbols.
+    uint16_t m_G[CONFIG_RS_LONG_MAX_PARITY]; ///< Generator polynomial (without the leading 1).
+
+    /// Multiplication in GF(65536).
+    /*!
+        \param[in] a 1st factor.
+        \param[in] b 2nd factor.
+        \return product.
+    */
+    static inline uint16_t gf_mul(uint16_t a, uint16_t b);
+    /// Remainder of the message from division by the generator polynomial.
+    /*!
+        \param[in] data pointer to the message (big-endian symbols).
+        \param[in] count number of symbols.
+        \param[out] reg pointer to the remainder (size parity).
+    */
+    void poly_remainder(uint8_t *data, uint32_t count, uint16_t *reg);
+    /// Generation of the tables.
+    /*!
+        \return true if success.
+    */
+    static bool buildTables();
+
+public:
+    static const uint32_t TABLES_SIZE = 2 * 65536 * sizeof(uint16_t); ///< Tables size.
+
+    /// Set memory for the tables.
+    /*!
+        Must be called before the first encode/decode. Required without PSRAM.
+        \param[in] mem pointer to the memory (PSRAM or static arena), 2 bytes aligned.
+        \param[in] size size of the memory (TABLES_SIZE).
+        \return true if success.
+    */
+    static bool setTableMemory(void *mem, uint32_t size);
+    /// Generation of the tables.
+    /*!
+        Called on the first encode/decode. Tables are checked against known vectors.
+        \return true if success.
+    */
+    static bool initTables();
+
+    /// Constructor.
+    /*!
+        \param[in] parity number of parity symbols (2 to CONFIG_RS_LONG_MAX_PARITY), parity/2 symbol errors are corrected.
+    */
+    RSEncodeLong(uint16_t parity = 16);
+
+    /// Parity size.
+    /*!
+        \return size of the parity in bytes.
+    */
+    inline uint32_t parity_size() { return 2 * m_parity; };
+
+    /// Encoding.
+    /*!
+        \param[in] data_in pointer to the input data array.
+        \param[in] size size of the input data (even).
+        \param[out] data_out pointer to the output data array (size of input + parity_size()).
+        \return false if the tables are not available.
+    */
+    bool encode(uint8_t *data_in, uint32_t size, uint8_t *data_out);
+    /// Decoding.
+    /*!
+        \param[in] data_in pointer to the input data array (size of output + parity_size()).
+        \param[out] data_out pointer to the output data array.
+        \param[in] size size of the output data (even).
+        \return number of corrected symbols, -1 if errors are not correctable.
+    */
+    int decode(uint8_t *data_in, uint8_t *data_out, uint32_t size);
+};
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*!
+    \file
+    \brief GF(256) field and generator polynomial of the (n+16,n) code.
+    \authors Bliznets R.A. (r.bliznets@gmail.com)
+    \version 1.0.1.0
+    \date 18.10.2026
+
+    Internal header of RSEncode16 and RSBitSlice.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define RS_POLY 0x11D ///< Field polynomial x^8 + x^4 + x^3 + x^2 + 1.
+#define RS_G 118, 52, 103, 31, 104, 126, 187, 232, 17, 56, 183, 49, 100, 81, 44, 79 ///< Generator polynomial coefficients.
+
+/// Multiplication in GF(256) without tables.
+static constexpr uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+    uint8_t res = 0;
+    while (b != 0)
+    {
+        if (b & 1)
+            res ^= a;
+        a = (a & 0x80) ? ((a << 1) ^ (RS_POLY & 0xFF)) : (a << 1);
+        b >>= 1;
+    }
+    return res;
+}
+
+/// Power of alpha.
+static constexpr uint8_t gf_alfa(uint32_t i)
+{
+    uint8_t res = 1;
+    for (uint32_t k = 0; k < i; k++)
+        res = gf_mul(res, 2);
+    return res;
+}
+
+/// Check of RS_G against G(x) = (x + alfa^1)...(x + alfa^16).
+/*!
+    \return true if all 16 coefficients match.
+*/
+static constexpr bool gf_generator_check()
+{
+    constexpr uint8_t ref[16] = {RS_G};
+    uint8_t g[17] = {1};
+    for (uint32_t i = 1; i <= 16; i++)
+    {
+        for (uint32_t k = i; k > 0; k--)
+            g[k] ^= gf_mul(gf_alfa(i), g[k - 1]);
+    }
+    for (uint32_t j = 0; j < 16; j++)
+    {
+        if (g[j + 1] != ref[j])
+            return false;
+    }
+    return true;
+}
+
+static_assert(gf_generator_check(), "RS_G is not the generator polynomial");
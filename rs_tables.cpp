@@ -0,0 +1,53 @@
+/*!
+    \file
+    \brief Memory and once-only generation of the runtime tables.
+    \authors Bliznets R.A. (r.bliznets@gmail.com)
+    \version 1.0.1.0
+    \date 18.10.2026
+*/
+
+#include "rs_tables.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+uint8_t *rs_tables_alloc(RSTablesMemory &m, uint32_t offset, uint32_t size)
+{
+    if (m.mem != nullptr)
+        return ((offset + size) <= m.mem_size) ? &m.mem[offset] : nullptr;
+    if (m.arena != nullptr)
+        return ((offset + size) <= m.arena_size) ? &m.arena[offset] : nullptr;
+    if (m.caps != 0)
+        return (uint8_t *)heap_caps_malloc(size, m.caps);
+    return nullptr;
+}
+
+void rs_tables_free(RSTablesMemory &m, uint8_t *mem)
+{
+    if ((m.mem == nullptr) && (m.arena == nullptr) && (m.caps != 0))
+        heap_caps_free(mem);
+}
+
+bool rs_tables_build(std::atomic<uint8_t> &state, bool (*build)())
+{
+    uint8_t st = state.load(std::memory_order_acquire);
+    while (st != TABLES_READY)
+    {
+        if (st == TABLES_NONE)
+        {
+            if (state.compare_exchange_weak(st, TABLES_BUSY, std::memory_order_acquire))
+            {
+                bool res = build();
+                state.store(res ? TABLES_READY : TABLES_NONE, std::memory_order_release);
+                return res;
+            }
+        }
+        else
+        {
+            // Another task is generating the tables
+            vTaskDelay(1);
+            st = state.load(std::memory_order_acquire);
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*!
+    \file
+    \brief Memory and once-only generation of the runtime tables.
+    \authors Bliznets R.A. (r.bliznets@gmail.com)
+    \version 1.0.1.0
+    \date 18.10.2026
+
+    Internal header of RSEncode16 and RSEncodeLong.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/// State of the generated tables.
+enum : uint8_t
+{
+    TABLES_NONE = 0, ///< Not generated.
+    TABLES_BUSY,     ///< Generation in progress.
+    TABLES_READY     ///< Generated and checked.
+};
+
+/// Memory for the generated tables.
+/*!
+    Parts of the tables are placed by offset in the caller memory or in the static arena,
+    otherwise every part is allocated from the heap.
+ */
+struct RSTablesMemory
+{
+    uint8_t *mem;        ///< Caller memory or nullptr.
+    uint32_t mem_size;   ///< Size of the caller memory.
+    uint8_t *arena;      ///< Static arena or nullptr.
+    uint32_t arena_size; ///< Size of the static arena.
+    uint32_t caps;       ///< Heap capabilities (0 - no heap).
+};
+
+/// Memory for a part of the tables.
+/*!
+    \param[in] m memory of the tables.
+    \param[in] offset offset of the part in the tables layout.
+    \param[in] size size of the part.
+    \return pointer to the memory or nullptr.
+*/
+uint8_t *rs_tables_alloc(RSTablesMemory &m, uint32_t offset, uint32_t size);
+/// Free memory of a part of the tables.
+/*!
+    \param[in] m memory of the tables.
+    \param[in] mem pointer to the memory from rs_tables_alloc() or nullptr.
+*/
+void rs_tables_free(RSTablesMemory &m, uint8_t *mem);
+/// Generation of a part of the tables (once).
+/*!
+    Concurrent callers wait until the generation is finished.
+    \param[in] state state of the part.
+    \param[in] build generation function.
+    \return true if the tables are ready.
+*/
+bool rs_tables_build(std::atomic<uint8_t> &state, bool (*build)());
\ No newline at end of file
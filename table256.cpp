@@ -12,13 +12,281 @@
 #include <stdint.h>
 #include "sdkconfig.h"
 #include "esp_attr.h"
+#include "rs_gf256.h"
+#ifdef CONFIG_RS_TABLES_RUNTIME
+#include <cstring>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "rs_tables.h"
+#endif // CONFIG_RS_TABLES_RUNTIME
 
 /// Generator polynomial.
 #ifdef CONFIG_RS_IN_RAM
 DRAM_ATTR
 #endif // CONFIG_RS_IN_RAM
-const uint8_t RSEncode16::m_G[16] = {118, 52, 103, 31, 104, 126, 187, 232, 17, 56, 183, 49, 100, 81, 44, 79};
+const uint8_t RSEncode16::m_G[16] = {RS_G};
 
+#if CONFIG_RS_ENCODER_SLICE > 1
+/// Slice tables for the encoder.
+/*!
+    tab[k][v] is the parity contribution (16 bytes as 4 words) of the byte v
+    at position k of a block of CONFIG_RS_ENCODER_SLICE message bytes.
+    \param[out] tab pointer to the tables.
+*/
+static constexpr void slice_fill(uint32_t (*tab)[256][4])
+{
+    constexpr uint8_t g[16] = {RS_G};
+    for (uint32_t k = 0; k < CONFIG_RS_ENCODER_SLICE; k++)
+    {
+        // Single bits: v*G and (CONFIG_RS_ENCODER_SLICE - 1 - k) zero steps of the division
+        for (uint32_t b = 0; b < 8; b++)
+        {
+            uint8_t reg[16] = {};
+            uint8_t fb = 1 << b;
+            for (uint32_t s = k; s < CONFIG_RS_ENCODER_SLICE; s++)
+            {
+                for (uint32_t j = 0; j < 15; j++)
+                    reg[j] = reg[j + 1] ^ gf_mul(fb, g[j]);
+                reg[15] = gf_mul(fb, g[15]);
+                fb = reg[0];
+            }
+            for (uint32_t j = 0; j < 4; j++)
+                tab[k][1 << b][j] = reg[4 * j] | (reg[4 * j + 1] << 8) | (reg[4 * j + 2] << 16) | ((uint32_t)reg[4 * j + 3] << 24);
+        }
+        // Other values by linearity
+        for (uint32_t j = 0; j < 4; j++)
+            tab[k][0][j] = 0;
+        for (uint32_t v = 3; v < 256; v++)
+        {
+            uint32_t low = v & (~v + 1);
+            if (low != v)
+            {
+                for (uint32_t j = 0; j < 4; j++)
+                    tab[k][v][j] = tab[k][v ^ low][j] ^ tab[k][low][j];
+            }
+        }
+    }
+}
+
+#ifndef CONFIG_RS_TABLES_RUNTIME
+/// Slice tables for the encoder.
+struct SliceTables
+{
+    uint32_t t[CONFIG_RS_ENCODER_SLICE][256][4];
+};
+
+/// Generation of the slice tables at compile time.
+static constexpr SliceTables slice_tables_make()
+{
+    SliceTables res{};
+    slice_fill(res.t);
+    return res;
+}
+
+#ifdef CONFIG_RS_IN_RAM
+DRAM_ATTR
+#endif // CONFIG_RS_IN_RAM
+static const SliceTables s_slice = slice_tables_make();
+
+const uint32_t (*const RSEncode16::gslice)[256][4] = s_slice.t;
+#endif // CONFIG_RS_TABLES_RUNTIME
+#endif // CONFIG_RS_ENCODER_SLICE
+
+#ifdef CONFIG_RS_TABLES_RUNTIME
+
+uint8_t *RSEncode16::ginv = nullptr;
+uint8_t *RSEncode16::galfa = nullptr;
+uint8_t (*RSEncode16::gmul)[256] = nullptr;
+#if CONFIG_RS_ENCODER_SLICE > 1
+uint32_t (*RSEncode16::gslice)[256][4] = nullptr;
+#else
+uint8_t (*RSEncode16::gmulG)[16] = nullptr;
+#endif
+
+static std::atomic<uint8_t> s_enc_state(TABLES_NONE); ///< State of the encoder tables.
+static std::atomic<uint8_t> s_dec_state(TABLES_NONE); ///< State of the decoder tables.
+
+#if defined(CONFIG_RS_TABLES_MEMORY_STATIC)
+#ifdef CONFIG_RS_TABLES_STATIC_ENCODER_ONLY
+/// Static arena for the encoder tables.
+static uint8_t s_arena[RSEncode16::TABLES_ENCODER_SIZE] __attribute__((aligned(4)));
+#else
+/// Static arena for the tables.
+static uint8_t s_arena[RSEncode16::TABLES_SIZE] __attribute__((aligned(4)));
+#endif
+/// Memory for the tables.
+static RSTablesMemory s_memory = {nullptr, 0, s_arena, sizeof(s_arena), 0};
+#elif defined(CONFIG_RS_TABLES_MEMORY_SPIRAM)
+/// Memory for the tables.
+static RSTablesMemory s_memory = {nullptr, 0, nullptr, 0, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT};
+#else
+/// Memory for the tables.
+static RSTablesMemory s_memory = {nullptr, 0, nullptr, 0, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT};
+#endif
+
+/// Known vector: parity of the message 1,2,...,17.
+static const uint8_t s_known_parity[16] = {231, 225, 24, 227, 20, 214, 168, 21, 0, 226, 36, 41, 55, 242, 7, 188};
+
+bool RSEncode16::setTableMemory(void *mem, uint32_t size)
+{
+    if ((mem == nullptr) || (size < TABLES_ENCODER_SIZE) || (((uintptr_t)mem & 3) != 0))
+        return false;
+    if ((s_enc_state.load() != TABLES_NONE) || (s_dec_state.load() != TABLES_NONE))
+        return false; // Tables are already generated
+
+    s_memory.mem = (uint8_t *)mem;
+    s_memory.mem_size = size;
+    return true;
+}
+
+void RSEncode16::releaseTables()
+{
+    // Heap memory is freed, caller and static memory is kept
+    rs_tables_free(s_memory, (uint8_t *)gmul);
+    gmul = nullptr;
+    galfa = nullptr;
+    ginv = nullptr;
+#if CONFIG_RS_ENCODER_SLICE > 1
+    rs_tables_free(s_memory, (uint8_t *)gslice);
+    gslice = nullptr;
+#else
+    rs_tables_free(s_memory, (uint8_t *)gmulG);
+    gmulG = nullptr;
+#endif
+
+    s_memory.mem = nullptr;
+    s_memory.mem_size = 0;
+    s_dec_state.store(TABLES_NONE);
+    s_enc_state.store(TABLES_NONE);
+}
+
+bool RSEncode16::buildEncoderTables()
+{
+    uint8_t *mem = rs_tables_alloc(s_memory, 0, TABLES_ENCODER_SIZE);
+    if (mem == nullptr)
+    {
+        ESP_LOGE("RSEncode16", "no memory for the encoder tables");
+        return false;
+    }
+
+#if CONFIG_RS_ENCODER_SLICE > 1
+    // Parity contributions of the message bytes
+    uint32_t(*tab)[256][4] = (uint32_t(*)[256][4])mem;
+    slice_fill(tab);
+    gslice = tab;
+#else
+    // Products by the generator polynomial coefficients
+    uint8_t(*mul)[16] = (uint8_t(*)[16])mem;
+    for (uint32_t x = 0; x < 256; x++)
+    {
+        for (uint32_t j = 0; j < 16; j++)
+            mul[x][j] = gf_mul(x, m_G[j]);
+    }
+    gmulG = mul;
+#endif
+
+    // Self-check: parity of the known message
+    uint8_t data[17 + 16];
+    uint8_t tmp[16];
+    for (uint32_t i = 0; i < sizeof(data); i++)
+        data[i] = (i < 17) ? (i + 1) : 0;
+    RSEncode16 rs;
+    rs.poly_remainder(data, tmp, 17);
+    if (std::memcmp(tmp, s_known_parity, 16) != 0)
+    {
+        ESP_LOGE("RSEncode16", "encoder tables check failed");
+#if CONFIG_RS_ENCODER_SLICE > 1
+        gslice = nullptr;
+#else
+        gmulG = nullptr;
+#endif
+        rs_tables_free(s_memory, mem);
+        return false;
+    }
+    return true;
+}
+
+bool RSEncode16::buildDecoderTables()
+{
+    uint8_t *mem = rs_tables_alloc(s_memory, TABLES_ENCODER_SIZE, TABLES_SIZE - TABLES_ENCODER_SIZE);
+    if (mem == nullptr)
+    {
+        ESP_LOGE("RSEncode16", "no memory for the decoder tables");
+        return false;
+    }
+    uint8_t(*mul)[256] = (uint8_t(*)[256])mem;
+    uint8_t *alfa = &mem[256 * 256];
+    uint8_t *inv = &alfa[256];
+
+    // Power and logarithm tables from the field polynomial
+    uint8_t log[256];
+    uint32_t x = 1;
+    log[0] = 0;
+    for (uint32_t i = 0; i < 255; i++)
+    {
+        alfa[i] = x;
+        log[x] = i;
+        x <<= 1;
+        if (x & 0x100)
+            x ^= RS_POLY;
+    }
+    alfa[255] = 1;
+
+    inv[0] = 0;
+    for (uint32_t a = 1; a < 256; a++)
+        inv[a] = alfa[(255 - log[a]) % 255];
+
+    for (uint32_t a = 0; a < 256; a++)
+    {
+        mul[a][0] = 0;
+        mul[0][a] = 0;
+    }
+    for (uint32_t a = 1; a < 256; a++)
+    {
+        for (uint32_t b = 1; b < 256; b++)
+        {
+            uint32_t k = log[a] + log[b];
+            mul[a][b] = alfa[(k < 255) ? k : (k - 255)];
+        }
+    }
+
+    // Self-check: inversion and generator polynomial G(x) = (x + alfa^1)...(x + alfa^16)
+    bool ok = true;
+    for (uint32_t a = 1; a < 256; a++)
+    {
+        if (mul[a][inv[a]] != 1)
+            ok = false;
+    }
+    uint8_t g[17] = {1};
+    for (uint32_t i = 1; i <= 16; i++)
+    {
+        for (uint32_t k = i; k > 0; k--)
+            g[k] ^= mul[alfa[i]][g[k - 1]];
+    }
+    if (!ok || (std::memcmp(&g[1], m_G, 16) != 0))
+    {
+        ESP_LOGE("RSEncode16", "decoder tables check failed");
+        rs_tables_free(s_memory, mem);
+        return false;
+    }
+
+    gmul = mul;
+    galfa = alfa;
+    ginv = inv;
+    return true;
+}
+
+bool RSEncode16::initTables(bool decoder)
+{
+    // The decoder also uses the encoder tables for the syndrome polynomial
+    if (!rs_tables_build(s_enc_state, buildEncoderTables))
+        return false;
+    if (!decoder)
+        return true;
+    return rs_tables_build(s_dec_state, buildDecoderTables);
+}
+
+#else
 /// Inversion table.
 #ifdef CONFIG_RS_IN_RAM
 DRAM_ATTR
@@ -308,3 +576,5 @@ const uint8_t RSEncode16::gmul[256][256] = {
     {0, 253, 231, 26, 211, 46, 52, 201, 187, 70, 92, 161, 104, 149, 143, 114, 107, 150, 140, 113, 184, 69, 95, 162, 208, 45, 55, 202, 3, 254, 228, 25, 214, 43, 49, 204, 5, 248, 226, 31, 109, 144, 138, 119, 190, 67, 89, 164, 189, 64, 90, 167, 110, 147, 137, 116, 6, 251, 225, 28, 213, 40, 50, 207, 177, 76, 86, 171, 98, 159, 133, 120, 10, 247, 237, 16, 217, 36, 62, 195, 218, 39, 61, 192, 9, 244, 238, 19, 97, 156, 134, 123, 178, 79, 85, 168, 103, 154, 128, 125, 180, 73, 83, 174, 220, 33, 59, 198, 15, 242, 232, 21, 12, 241, 235, 22, 223, 34, 56, 197, 183, 74, 80, 173, 100, 153, 131, 126, 127, 130, 152, 101, 172, 81, 75, 182, 196, 57, 35, 222, 23, 234, 240, 13, 20, 233, 243, 14, 199, 58, 32, 221, 175, 82, 72, 181, 124, 129, 155, 102, 169, 84, 78, 179, 122, 135, 157, 96, 18, 239, 245, 8, 193, 60, 38, 219, 194, 63, 37, 216, 17, 236, 246, 11, 121, 132, 158, 99, 170, 87, 77, 176, 206, 51, 41, 212, 29, 224, 250, 7, 117, 136, 146, 111, 166, 91, 65, 188, 165, 88, 66, 191, 118, 139, 145, 108, 30, 227, 249, 4, 205, 48, 42, 215, 24, 229, 255, 2, 203, 54, 44, 209, 163, 94, 68, 185, 112, 141, 151, 106, 115, 142, 148, 105, 160, 93, 71, 186, 200, 53, 47, 210, 27, 230, 252, 1},
     {0, 254, 225, 31, 223, 33, 62, 192, 163, 93, 66, 188, 124, 130, 157, 99, 91, 165, 186, 68, 132, 122, 101, 155, 248, 6, 25, 231, 39, 217, 198, 56, 182, 72, 87, 169, 105, 151, 136, 118, 21, 235, 244, 10, 202, 52, 43, 213, 237, 19, 12, 242, 50, 204, 211, 45, 78, 176, 175, 81, 145, 111, 112, 142, 113, 143, 144, 110, 174, 80, 79, 177, 210, 44, 51, 205, 13, 243, 236, 18, 42, 212, 203, 53, 245, 11, 20, 234, 137, 119, 104, 150, 86, 168, 183, 73, 199, 57, 38, 216, 24, 230, 249, 7, 100, 154, 133, 123, 187, 69, 90, 164, 156, 98, 125, 131, 67, 189, 162, 92, 63, 193, 222, 32, 224, 30, 1, 255, 226, 28, 3, 253, 61, 195, 220, 34, 65, 191, 160, 94, 158, 96, 127, 129, 185, 71, 88, 166, 102, 152, 135, 121, 26, 228, 251, 5, 197, 59, 36, 218, 84, 170, 181, 75, 139, 117, 106, 148, 247, 9, 22, 232, 40, 214, 201, 55, 15, 241, 238, 16, 208, 46, 49, 207, 172, 82, 77, 179, 115, 141, 146, 108, 147, 109, 114, 140, 76, 178, 173, 83, 48, 206, 209, 47, 239, 17, 14, 240, 200, 54, 41, 215, 23, 233, 246, 8, 107, 149, 138, 116, 180, 74, 85, 171, 37, 219, 196, 58, 250, 4, 27, 229, 134, 120, 103, 153, 89, 167, 184, 70, 126, 128, 159, 97, 161, 95, 64, 190, 221, 35, 60, 194, 2, 252, 227, 29},
     {0, 255, 227, 28, 219, 36, 56, 199, 171, 84, 72, 183, 112, 143, 147, 108, 75, 180, 168, 87, 144, 111, 115, 140, 224, 31, 3, 252, 59, 196, 216, 39, 150, 105, 117, 138, 77, 178, 174, 81, 61, 194, 222, 33, 230, 25, 5, 250, 221, 34, 62, 193, 6, 249, 229, 26, 118, 137, 149, 106, 173, 82, 78, 177, 49, 206, 210, 45, 234, 21, 9, 246, 154, 101, 121, 134, 65, 190, 162, 93, 122, 133, 153, 102, 161, 94, 66, 189, 209, 46, 50, 205, 10, 245, 233, 22, 167, 88, 68, 187, 124, 131, 159, 96, 12, 243, 239, 16, 215, 40, 52, 203, 236, 19, 15, 240, 55, 200, 212, 43, 71, 184, 164, 91, 156, 99, 127, 128, 98, 157, 129, 126, 185, 70, 90, 165, 201, 54, 42, 213, 18, 237, 241, 14, 41, 214, 202, 53, 242, 13, 17, 238, 130, 125, 97, 158, 89, 166, 186, 69, 244, 11, 23, 232, 47, 208, 204, 51, 95, 160, 188, 67, 132, 123, 103, 152, 191, 64, 92, 163, 100, 155, 135, 120, 20, 235, 247, 8, 207, 48, 44, 211, 83, 172, 176, 79, 136, 119, 107, 148, 248, 7, 27, 228, 35, 220, 192, 63, 24, 231, 251, 4, 195, 60, 32, 223, 179, 76, 80, 175, 104, 151, 139, 116, 197, 58, 38, 217, 30, 225, 253, 2, 110, 145, 141, 114, 181, 74, 86, 169, 142, 113, 109, 146, 85, 170, 182, 73, 37, 218, 198, 57, 254, 1, 29, 226}};
+
+#endif // CONFIG_RS_TABLES_RUNTIME
@@ -10,12 +10,23 @@
 #include <cstring>
 #include "unity.h"
 #include "RSEncode16.h"
+#include "RSEncodeLong.h"
+#include "RSBitSlice.h"
+#include "esp_crc.h"
+#include "esp_heap_caps.h"
 #include "CTrace.h"
 
 #define countof(x) (sizeof(x)/sizeof(x[0]))
 
 TEST_CASE("RSEncode16", "[encode][decode][fec]")
 {
+#ifdef CONFIG_RS_TABLES_STATIC_ENCODER_ONLY
+   TEST_IGNORE_MESSAGE("No memory for decoder tables");
+#endif
+#ifdef CONFIG_RS_TABLES_RUNTIME
+   // Tables are generated once and not freed
+   TEST_ASSERT_TRUE(RSEncode16::initTables());
+#endif
    uint32_t mem1=esp_get_free_heap_size();
 
    RSEncode16* enc=nullptr;
@@ -31,8 +42,9 @@ TEST_CASE("RSEncode16", "[encode][decode][fec]")
    uint8_t dt3[countof(dt1)];
 
    STARTTIMESHOT();
-   enc->encode(dt1,countof(dt1),dt2);
+   bool res=enc->encode(dt1,countof(dt1),dt2);
    STOPTIMESHOT("encode time");
+   TEST_ASSERT_TRUE(res);
    
    dt2[0]^=0x01;
    dt2[1]^=0x71;
@@ -43,8 +55,9 @@ TEST_CASE("RSEncode16", "[encode][decode][fec]")
    dt2[31]^=0x71;
    dt2[32]^=0x71;
    STARTTIMESHOT();
-   enc->decode(dt2,dt3,countof(dt3));
+   res=enc->decode(dt2,dt3,countof(dt3));
    STOPTIMESHOT("decode time");
+   TEST_ASSERT_TRUE(res);
    TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, countof(dt1));
 
    delete enc;
@@ -59,3 +72,265 @@ TEST_CASE("RSEncode16", "[encode][decode][fec]")
    }
 }
 
+TEST_CASE("RSEncode16 CRC32", "[encode][decode][fec][crc]")
+{
+#ifdef CONFIG_RS_TABLES_STATIC_ENCODER_ONLY
+   TEST_IGNORE_MESSAGE("No memory for decoder tables");
+#endif
+   RSEncode16* enc=nullptr;
+   enc = new RSEncode16();
+   TEST_ASSERT_NOT_EQUAL(nullptr, enc);
+
+   uint8_t dt1[120];
+   for(uint8_t i = 0; i< countof(dt1);i++)
+   {
+	   dt1[i]=i+1;
+   }
+   uint8_t dt2[136];
+   uint8_t dt3[countof(dt1)];
+   uint8_t dt4[136];
+
+   uint32_t crc=0;
+   STARTTIMESHOT();
+   bool res=enc->encode_with_crc(dt1,countof(dt1),dt2,&crc);
+   STOPTIMESHOT("encode_with_crc time");
+   TEST_ASSERT_TRUE(res);
+   TEST_ASSERT_EQUAL_UINT32(esp_crc32_le(0,dt1,countof(dt1)), crc);
+   TEST_ASSERT_TRUE(enc->encode(dt1,countof(dt1),dt4));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt4, dt2, countof(dt2));
+
+   STARTTIMESHOT();
+   TEST_ASSERT_TRUE(enc->decode_with_crc(dt2,dt3,countof(dt3),crc));
+   STOPTIMESHOT("decode_with_crc time");
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, countof(dt1));
+
+   dt2[0]^=0x01;
+   dt2[31]^=0x71;
+   dt2[130]^=0x71;
+   TEST_ASSERT_TRUE(enc->decode_with_crc(dt2,dt3,countof(dt3),crc));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, countof(dt1));
+   TEST_ASSERT_FALSE(enc->decode_with_crc(dt2,dt3,countof(dt3),crc^1));
+
+   // CRC32 chained over two frames
+   uint32_t crc1=0;
+   TEST_ASSERT_TRUE(enc->encode_with_crc(dt1,60,dt2,&crc1));
+   uint32_t crc2=crc1;
+   TEST_ASSERT_TRUE(enc->encode_with_crc(&dt1[60],60,dt4,&crc2));
+   TEST_ASSERT_EQUAL_UINT32(crc, crc2);
+   dt4[5]^=0x33;
+   TEST_ASSERT_TRUE(enc->decode_with_crc(dt2,dt3,60,crc1));
+   TEST_ASSERT_TRUE(enc->decode_with_crc(dt4,&dt3[60],60,crc2,crc1));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, countof(dt1));
+   TEST_ASSERT_FALSE(enc->decode_with_crc(dt4,&dt3[60],60,crc2));
+
+   delete enc;
+}
+
+#ifdef CONFIG_RS_TABLES_RUNTIME
+TEST_CASE("RSEncode16 table memory", "[encode][decode][fec][tables]")
+{
+   // Known vector: parity of the message 1,2,...,17
+   const uint8_t parity[16] = {231, 225, 24, 227, 20, 214, 168, 21, 0, 226, 36, 41, 55, 242, 7, 188};
+   // Free the tables of the previous tests before the arena is allocated
+   RSEncode16::releaseTables();
+   uint32_t* arena = (uint32_t*)heap_caps_malloc(RSEncode16::TABLES_SIZE, MALLOC_CAP_8BIT);
+   TEST_ASSERT_NOT_EQUAL(nullptr, arena);
+
+   RSEncode16* enc=nullptr;
+   enc = new RSEncode16();
+   TEST_ASSERT_NOT_EQUAL(nullptr, enc);
+
+   uint8_t dt1[17];
+   for(uint8_t i = 0; i< countof(dt1);i++)
+   {
+	   dt1[i]=i+1;
+   }
+   uint8_t dt2[countof(dt1)+16];
+   uint8_t dt3[countof(dt1)];
+
+   TEST_ASSERT_FALSE(RSEncode16::setTableMemory((uint8_t*)arena+1,RSEncode16::TABLES_SIZE));
+   TEST_ASSERT_FALSE(RSEncode16::setTableMemory(arena,RSEncode16::TABLES_ENCODER_SIZE-4));
+
+   // Encoder tables only
+   TEST_ASSERT_TRUE(RSEncode16::setTableMemory(arena,RSEncode16::TABLES_ENCODER_SIZE));
+   TEST_ASSERT_TRUE(RSEncode16::initTables(false));
+   TEST_ASSERT_FALSE(RSEncode16::setTableMemory(arena,RSEncode16::TABLES_SIZE));
+   TEST_ASSERT_TRUE(enc->encode(dt1,countof(dt1),dt2));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(parity, &dt2[countof(dt1)], 16);
+   TEST_ASSERT_FALSE(enc->decode(dt2,dt3,countof(dt1)));
+   TEST_ASSERT_FALSE(RSEncode16::initTables());
+
+   // All tables in the caller arena
+   RSEncode16::releaseTables();
+   TEST_ASSERT_TRUE(RSEncode16::setTableMemory(arena,RSEncode16::TABLES_SIZE));
+   TEST_ASSERT_TRUE(enc->encode(dt1,countof(dt1),dt2));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(parity, &dt2[countof(dt1)], 16);
+   dt2[3]^=0x55;
+   dt2[20]^=0x01;
+   TEST_ASSERT_TRUE(enc->decode(dt2,dt3,countof(dt1)));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, countof(dt1));
+
+   // Back to the memory selected in menuconfig
+   RSEncode16::releaseTables();
+
+   delete enc;
+   heap_caps_free(arena);
+}
+#endif // CONFIG_RS_TABLES_RUNTIME
+
+TEST_CASE("RSEncodeLong", "[encode][decode][fec][long]")
+{
+#ifdef CONFIG_RS_LONG_TABLES_MEMORY_CALLER
+   // Without PSRAM the tables need memory from setTableMemory()
+   if(!RSEncodeLong::initTables())
+      TEST_IGNORE_MESSAGE("No memory for GF(2^16) tables");
+#else
+   TEST_ASSERT_TRUE(RSEncodeLong::initTables());
+#endif
+
+   RSEncodeLong* enc=nullptr;
+   enc = new RSEncodeLong(16);
+   TEST_ASSERT_NOT_EQUAL(nullptr, enc);
+   TEST_ASSERT_EQUAL_UINT32(32, enc->parity_size());
+
+   uint8_t* dt1 = new uint8_t[4096];
+   uint8_t* dt2 = new uint8_t[4096+32];
+   uint8_t* dt3 = new uint8_t[4096];
+   for(uint32_t i = 0; i < 4096; i++)
+   {
+	   dt1[i]=i*13+1;
+   }
+
+   STARTTIMESHOT();
+   bool res=enc->encode(dt1,4096,dt2);
+   STOPTIMESHOT("long encode time");
+   TEST_ASSERT_TRUE(res);
+   TEST_ASSERT_EQUAL(0, enc->decode(dt2,dt3,4096));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, 4096);
+
+   dt2[0]^=0x01;
+   dt2[1001]^=0x71;
+   dt2[2048]^=0x71;
+   dt2[2049]^=0x17;
+   dt2[3000]^=0xFF;
+   dt2[4095]^=0x71;
+   dt2[4100]^=0x71;
+   dt2[4127]^=0x71;
+   STARTTIMESHOT();
+   TEST_ASSERT_EQUAL(7, enc->decode(dt2,dt3,4096));
+   STOPTIMESHOT("long decode time");
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, 4096);
+
+   dt2[10]^=0x01;
+   dt2[20]^=0x01;
+   TEST_ASSERT_EQUAL(-1, enc->decode(dt2,dt3,4096));
+
+   // Odd number of parity symbols
+   delete enc;
+   enc = new RSEncodeLong(15);
+   TEST_ASSERT_NOT_EQUAL(nullptr, enc);
+   TEST_ASSERT_TRUE(enc->encode(dt1,1000,dt2));
+   for(uint32_t i = 0; i < 7; i++)
+   {
+	   dt2[i*143]^=0x5A;
+   }
+   TEST_ASSERT_EQUAL(7, enc->decode(dt2,dt3,1000));
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt3, 1000);
+
+   delete[] dt3;
+   delete[] dt2;
+   delete[] dt1;
+   delete enc;
+}
+
+TEST_CASE("RSBitSlice", "[encode][fec][bitslice]")
+{
+   RSEncode16* enc=nullptr;
+   enc = new RSEncode16();
+   TEST_ASSERT_NOT_EQUAL(nullptr, enc);
+
+   const uint32_t count = RSBitSlice<uint32_t>::WIDTH;
+   uint8_t* dt1 = new uint8_t[count*136];
+   uint8_t* dt2 = new uint8_t[count*136];
+   uint32_t (*planes)[8] = new uint32_t[136][8];
+   for(uint32_t i = 0; i < count*136; i++)
+   {
+	   dt1[i]=i*7+1;
+   }
+   for(uint32_t c = 0; c < count; c++)
+   {
+	   TEST_ASSERT_TRUE(enc->encode(&dt1[c*136],120,&dt1[c*136]));
+   }
+
+   STARTTIMESHOT();
+   RSBitSlice<uint32_t>::transpose(dt1,136,120,count,planes);
+   RSBitSlice<uint32_t>::encode(planes,120);
+   RSBitSlice<uint32_t>::untranspose(planes,136,count,dt2,136);
+   STOPTIMESHOT("bit-slice encode time");
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(dt1, dt2, count*136);
+   TEST_ASSERT_EQUAL_UINT32(0, RSBitSlice<uint32_t>::check(planes,120));
+
+   dt2[5*136+3]^=0x71;
+   dt2[30*136+130]^=0x01;
+   RSBitSlice<uint32_t>::transpose(dt2,136,136,count,planes);
+   TEST_ASSERT_EQUAL_UINT32((1<<5)|(1<<30), RSBitSlice<uint32_t>::check(planes,120));
+
+   delete[] planes;
+   delete[] dt2;
+   delete[] dt1;
+   delete enc;
+}
+
+
+TEST_CASE("RSBitSlice partial batch", "[encode][fec][bitslice]")
+{
+   RSEncode16* enc=nullptr;
+   enc = new RSEncode16();
+   TEST_ASSERT_NOT_EQUAL(nullptr, enc);
+
+   // 64-bit planes, part of a batch, gaps between codewords
+   const uint32_t width = RSBitSlice<uint64_t>::WIDTH;
+   const uint32_t count = 37;
+   const uint32_t stride = 150;
+   uint8_t* dt1 = new uint8_t[width*stride];
+   uint8_t* dt2 = new uint8_t[width*stride];
+   uint64_t (*planes)[8] = new uint64_t[116][8];
+   memset(dt1,0,width*stride);
+   for(uint32_t c = 0; c < count; c++)
+   {
+	   for(uint32_t i = 0; i < 100; i++)
+	   {
+		   dt1[c*stride+i]=c*31+i*7+1;
+	   }
+	   TEST_ASSERT_TRUE(enc->encode(&dt1[c*stride],100,&dt1[c*stride]));
+   }
+   memset(dt2,0xFF,width*stride);
+
+   STARTTIMESHOT();
+   RSBitSlice<uint64_t>::transpose(dt1,stride,100,count,planes);
+   RSBitSlice<uint64_t>::encode(planes,100);
+   RSBitSlice<uint64_t>::untranspose(planes,116,width,dt2,stride);
+   STOPTIMESHOT("bit-slice partial encode time");
+   for(uint32_t c = 0; c < width; c++)
+   {
+	   // Missing codewords are encoded as zero
+	   TEST_ASSERT_EQUAL_UINT8_ARRAY(&dt1[c*stride], &dt2[c*stride], 116);
+	   TEST_ASSERT_EACH_EQUAL_UINT8(0xFF, &dt2[c*stride+116], stride-116);
+   }
+   // 64-bit Unity asserts need CONFIG_UNITY_ENABLE_64BIT, compare 32-bit halves
+   uint64_t mask=RSBitSlice<uint64_t>::check(planes,100);
+   TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)mask);
+   TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(mask>>32));
+
+   dt1[0*stride+99]^=0x10;
+   dt1[36*stride+115]^=0x80;
+   RSBitSlice<uint64_t>::transpose(dt1,stride,116,count,planes);
+   mask=RSBitSlice<uint64_t>::check(planes,100);
+   TEST_ASSERT_EQUAL_UINT32(1<<0, (uint32_t)mask);
+   TEST_ASSERT_EQUAL_UINT32(1<<(36-32), (uint32_t)(mask>>32));
+
+   delete[] planes;
+   delete[] dt2;
+   delete[] dt1;
+   delete enc;
+}